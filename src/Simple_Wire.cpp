@@ -26,6 +26,44 @@ Version 2.0 3-3-2025 Streamlined, added features and improved performance
 #include "Simple_Wire.h"
 #include <Wire.h>
 
+// SMBus PEC lookup table, CRC-8 polynomial 0x07, indexed by (crc ^ data)
+const uint8_t Simple_Wire::SMBusCrcTable[256] PROGMEM = {
+  0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
+  0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65, 0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D,
+  0xE0, 0xE7, 0xEE, 0xE9, 0xFC, 0xFB, 0xF2, 0xF5, 0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
+  0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85, 0xA8, 0xAF, 0xA6, 0xA1, 0xB4, 0xB3, 0xBA, 0xBD,
+  0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2, 0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA,
+  0xB7, 0xB0, 0xB9, 0xBE, 0xAB, 0xAC, 0xA5, 0xA2, 0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
+  0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32, 0x1F, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0D, 0x0A,
+  0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42, 0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A,
+  0x89, 0x8E, 0x87, 0x80, 0x95, 0x92, 0x9B, 0x9C, 0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
+  0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC, 0xC1, 0xC6, 0xCF, 0xC8, 0xDD, 0xDA, 0xD3, 0xD4,
+  0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C, 0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44,
+  0x19, 0x1E, 0x17, 0x10, 0x05, 0x02, 0x0B, 0x0C, 0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
+  0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B, 0x76, 0x71, 0x78, 0x7F, 0x6A, 0x6D, 0x64, 0x63,
+  0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B, 0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
+  0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
+  0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3};
+
+Simple_Wire *Simple_Wire::_target = nullptr;
+
+// Target mode bank lock. On ESP32 the Wire target callbacks run in a FreeRTOS task, possibly on the other core, and
+// noInterrupts() does nothing, so a spinlock guards the bank in the callbacks and the application side alike.
+// Elsewhere the callbacks run from the I2C interrupt, turning interrupts off in the application is enough and the
+// callbacks need no lock. RP2040 is covered as long as Wire and the sketch run on the same core.
+#if defined(ESP32)
+static portMUX_TYPE BankMux = portMUX_INITIALIZER_UNLOCKED;
+#define BANK_LOCK() portENTER_CRITICAL(&BankMux)
+#define BANK_UNLOCK() portEXIT_CRITICAL(&BankMux)
+#define BANK_LOCK_CALLBACK() portENTER_CRITICAL(&BankMux)
+#define BANK_UNLOCK_CALLBACK() portEXIT_CRITICAL(&BankMux)
+#else
+#define BANK_LOCK() noInterrupts()
+#define BANK_UNLOCK() interrupts()
+#define BANK_LOCK_CALLBACK()
+#define BANK_UNLOCK_CALLBACK()
+#endif
+
 Simple_Wire::Simple_Wire() { // Constructor
 }
 
@@ -37,7 +75,7 @@ void Simple_Wire::begin(int sdaPin, int sclPin) {
   Wire.begin();
 
   Wire.setClock(400000);           // 400kHz I2C clock.
-  Wire.setWireTimeout(3000, true); // timeout value in uSec
+  Wire.setWireTimeout(WIRE_TIMEOUT_US, true); // timeout value in uSec
 #elif defined(ESP8266) || defined(ESP32)
   Wire.begin(sdaPin, sclPin, (uint32_t)400000); // 400kHz I2C clock.
 
@@ -54,6 +92,158 @@ void Simple_Wire::begin(int sdaPin, int sclPin) {
 #endif
   _sdaPin = sdaPin;
   _sclPin = sclPin;
+  _clockHz = 400000;
+}
+
+// Target (slave) mode, answer at address from the register bank instead of driving the bus
+Simple_Wire &Simple_Wire::beginTarget(uint8_t address, uint8_t *Bank, uint8_t size, const uint8_t *Flags, uint8_t *Shadow, int sdaPin, int sclPin) {
+  ErrorMessage = 0;
+  if (!Bank || !size) {
+    ErrorMessage = 4; // No register bank
+    return *this;
+  }
+  _bankFront = Bank;
+  _bankBack = Shadow;
+  _bankFlags = Flags;
+  _bankSize = size;
+  _bankHasWO = false;
+  for (uint8_t i = 0; Flags && i < size; i++)
+    _bankHasWO |= (Flags[i] & SW_REG_WO) != 0;
+  if (Shadow)
+    memcpy(Shadow, Bank, size);
+  _regPtr = 0;
+  _target = this;
+
+  Wire.onReceive(TargetReceive);
+  Wire.onRequest(TargetRequest);
+#ifdef __AVR__
+  Wire.begin(address);
+#elif defined(ESP8266)
+  Wire.begin(sdaPin, sclPin, address);
+#elif defined(ESP32)
+  Wire.begin(address, sdaPin, sclPin, (uint32_t)0);
+#elif defined(ARDUINO_ARCH_RP2040)
+  Wire.setSCL(sclPin);
+  Wire.setSDA(sdaPin);
+  Wire.begin(address);
+#else
+  Wire.begin(address);
+#endif
+  _sdaPin = sdaPin;
+  _sclPin = sclPin;
+  return *this;
+}
+
+// Host wrote to us: first byte is the register pointer, any following bytes land in the bank with auto-increment.
+// Runs in interrupt context so it only touches the bank and calls back once per transaction.
+// The bytes are pulled out of Wire before the bank is locked so no Wire call runs inside the lock.
+void Simple_Wire::TargetReceive(int count) {
+  Simple_Wire *t = _target;
+  if (!t || count <= 0)
+    return;
+  uint8_t Reg = Wire.read();
+  uint8_t First = Reg;
+  uint8_t Bytes[WIRE_BUFFER_LENGTH];
+  uint8_t Received = 0;
+  while (--count > 0) {
+    uint8_t Byte = Wire.read();
+    if (Received < WIRE_BUFFER_LENGTH)
+      Bytes[Received++] = Byte;
+  }
+  uint8_t Written = 0;
+  bool Notify = false;
+  BANK_LOCK_CALLBACK();
+  for (uint8_t i = 0; i < Received && Reg < t->_bankSize; i++) { // anything past the end of the bank is dropped
+    uint8_t Flags = t->_bankFlags ? t->_bankFlags[Reg] : SW_REG_RW;
+    if (!(Flags & SW_REG_RO)) {
+      Notify |= (t->_bankFront[Reg] != Bytes[i]) || (Flags & SW_REG_VOLATILE);
+      t->_bankFront[Reg] = Bytes[i];
+      if (t->_bankBack)
+        t->_bankBack[Reg] = Bytes[i]; // keep the staging copy in step so the next swap does not undo the host
+    }
+    Reg++;
+    Written++;
+  }
+  t->_regPtr = Reg;
+  BANK_UNLOCK_CALLBACK();
+  if (Notify && t->_onTargetWrite)
+    t->_onTargetWrite(First, Written);
+}
+
+// Host is reading: hand the bank to Wire from the register pointer on. Wire copies it into its transmit buffer,
+// we add no staging copy of our own unless write only registers must be hidden.
+// On ESP32 the bytes are taken under the bank lock first, Wire.write() must not run inside a critical section.
+void Simple_Wire::TargetRequest() {
+  Simple_Wire *t = _target;
+  if (!t)
+    return;
+  uint8_t Reg = t->_regPtr;
+  if (Reg >= t->_bankSize) {
+    Wire.write((uint8_t)0);
+    return;
+  }
+  uint8_t length = min<uint16_t>(t->_bankSize - Reg, WIRE_BUFFER_LENGTH);
+#if defined(ESP32)
+  uint8_t Bytes[WIRE_BUFFER_LENGTH];
+  BANK_LOCK_CALLBACK();
+  for (uint8_t i = 0; i < length; i++)
+    Bytes[i] = (t->_bankHasWO && (t->_bankFlags[Reg + i] & SW_REG_WO)) ? 0 : t->_bankFront[Reg + i];
+  BANK_UNLOCK_CALLBACK();
+  Wire.write(Bytes, length);
+#else
+  if (!t->_bankHasWO) {
+    Wire.write(t->_bankFront + Reg, length);
+    return;
+  }
+  for (uint8_t i = Reg; i < Reg + length; i++)
+    Wire.write((t->_bankFlags[i] & SW_REG_WO) ? (uint8_t)0 : t->_bankFront[i]);
+#endif
+}
+
+// Application side update of the bank
+Simple_Wire &Simple_Wire::TargetWriteBytes(uint8_t regAddr, uint8_t length, const uint8_t *Data) {
+  ErrorMessage = 0;
+  if ((uint16_t)regAddr + length > _bankSize) {
+    ErrorMessage = 1; // Past the end of the register bank
+    return *this;
+  }
+  BANK_LOCK();
+  if (_bankBack) {
+    memcpy(_bankBack + regAddr, Data, length);
+    _dirtyLo = min<uint8_t>(_dirtyLo, regAddr);
+    _dirtyHi = max<uint8_t>(_dirtyHi, regAddr + length);
+  } else {
+    memcpy(_bankFront + regAddr, Data, length);
+  }
+  BANK_UNLOCK();
+  return *this;
+}
+
+// Publish the staged bank: swap front and back, then bring the new back up to date with what was staged.
+// Only the staged range differs between the two banks (host writes go to both), so that is all we copy.
+Simple_Wire &Simple_Wire::TargetSwap() {
+  if (!_bankBack || _dirtyLo >= _dirtyHi)
+    return *this;
+  BANK_LOCK();
+  uint8_t *Front = _bankBack;
+  _bankBack = _bankFront;
+  _bankFront = Front;
+  memcpy(_bankBack + _dirtyLo, _bankFront + _dirtyLo, _dirtyHi - _dirtyLo);
+  BANK_UNLOCK();
+  _dirtyLo = 0xFF;
+  _dirtyHi = 0;
+  return *this;
+}
+
+// Multi-byte values go into the bank in the same byte order TWrite() puts them on the bus
+template <typename T>
+Simple_Wire &Simple_Wire::TTargetWrite(uint8_t regAddr, uint8_t ByteC, T Val) {
+  uint8_t Bytes[8];
+  for (int8_t b = ByteC - 1; b >= 0; b--) {
+    uint8_t Shift = ReverseByteShift ? (ByteC - 1 - b) * 8 : b * 8;
+    Bytes[ByteC - 1 - b] = (uint8_t)(Val >> Shift);
+  }
+  return TargetWriteBytes(regAddr, ByteC, Bytes);
 }
 
 // ESP32 optimized WriteThenRead with repeated start (template version)
@@ -77,6 +267,13 @@ Simple_Wire &Simple_Wire::TWriteThenRead(uint8_t altAddress, uint8_t regAddr, T
   uint8_t byteCount = sizeof(T);
   uint8_t totalBytes = readLength * byteCount;
 
+  // The repeated start holds the bus between write and read, so both halves must fit the budget before we begin
+  StartBudget();
+  if (!HaveTime(BusTimeUs(totalBytes + 3))) {
+    ErrorMessage = 5; // Timeout
+    return *this;
+  }
+
   // Write register address with repeated start
   Wire.beginTransmission(altAddress);
   Wire.write(regAddr);
@@ -86,7 +283,7 @@ Simple_Wire &Simple_Wire::TWriteThenRead(uint8_t altAddress, uint8_t regAddr, T
     // Request data with timeout
     Wire.requestFrom(static_cast<uint8_t>(altAddress), static_cast<size_t>(totalBytes), static_cast<bool>(true)); // send STOP after read
 
-    uint32_t startTime = millis();
+    // The transfer is finished once requestFrom() returns, copying out of the Wire buffer is not timed
     uint8_t index = 0;
 
     while (Wire.available() && index < readLength) {
@@ -102,17 +299,11 @@ Simple_Wire &Simple_Wire::TWriteThenRead(uint8_t altAddress, uint8_t regAddr, T
         }
       }
       index++;
-
-      // Fail fast on timeout
-      if (millis() - startTime > _timeoutMs) {
-        ErrorMessage = 5; // Timeout
-        break;
-      }
     }
 
     I2CReadCount = index;
-    if (I2CReadCount != readLength) {
-      ErrorMessage = 4; // Incomplete read
+    if (I2CReadCount != readLength && Success()) {
+      ErrorMessage = ShortReadError();
     }
   }
 
@@ -125,6 +316,285 @@ Simple_Wire &Simple_Wire::SetTimeout(uint32_t timeoutMs) {
   return *this;
 }
 
+// Set the bus clock, also used to estimate how long a transfer will take against its budget
+Simple_Wire &Simple_Wire::SetClock(uint32_t hz) {
+  _clockHz = max<uint32_t>(hz, 1000);
+  Wire.setClock(_clockHz);
+  return *this;
+}
+
+// Start one budget shared by every call until ClearDeadline()
+Simple_Wire &Simple_Wire::StartDeadline(uint32_t us) {
+  _deadlineStart = micros();
+  _deadlineUs = us;
+  _batchDeadline = true;
+  return *this;
+}
+
+// Start the budget for a new transaction, a running StartDeadline() budget is left alone
+void Simple_Wire::StartBudget() {
+  if (_batchDeadline) {
+#if defined(WIRE_HAS_TIMEOUT)
+    Wire.clearWireTimeoutFlag();
+#endif
+    return;
+  }
+  _deadlineStart = micros();
+  if (_budgetUs)
+    _deadlineUs = _budgetUs;
+  else if (!_timeoutMs)
+    _deadlineUs = 0xFFFFFFFFUL; // SetTimeout(0), no limit
+  else
+    _deadlineUs = (_timeoutMs > 4000000UL) ? 4000000000UL : _timeoutMs * 1000UL; // keep inside the micros() wrap
+#if defined(WIRE_HAS_TIMEOUT)
+  Wire.clearWireTimeoutFlag(); // so ShortReadError() only sees a timeout from this transaction
+#endif
+}
+
+uint32_t Simple_Wire::RemainingUs() {
+  uint32_t Elapsed = micros() - _deadlineStart;
+  return (Elapsed >= _deadlineUs) ? 0 : _deadlineUs - Elapsed;
+}
+
+// True when needUs more bus time still fits in the budget.
+// With a microsecond budget the core's Wire timeout is set to what is left, so a stuck or stretched transfer is
+// cut off by Wire itself instead of blocking past the deadline. AVR takes microseconds and resets the bus,
+// ESP32 takes milliseconds so the budget is rounded up. Other cores keep their own Wire timeout.
+bool Simple_Wire::HaveTime(uint32_t needUs) {
+  uint32_t Remaining = RemainingUs();
+  if (Remaining <= needUs || !(_budgetUs || _batchDeadline)) {
+    RestoreBusTimeout(); // nothing will go on the bus under a spent budget, leave Wire as begin() set it
+    return Remaining > needUs;
+  }
+#if defined(WIRE_HAS_TIMEOUT)
+  Wire.setWireTimeout(Remaining, true);
+  _busTimeoutArmed = true;
+#elif defined(ESP32)
+  if (!_busTimeoutArmed)
+    _coreTimeoutMs = Wire.getTimeOut();
+  Wire.setTimeOut((uint16_t)min<uint32_t>((Remaining + 999) / 1000, 0xFFFF));
+  _busTimeoutArmed = true;
+#endif
+  return true;
+}
+
+// Put the core's Wire timeout back to its default. Called when a budget ends (SetBudget(0), ClearDeadline()) or
+// runs out, not after every budgeted transaction, so while a budget is active Wire keeps the last value we set.
+void Simple_Wire::RestoreBusTimeout() {
+  if (!_busTimeoutArmed)
+    return;
+#if defined(WIRE_HAS_TIMEOUT)
+  Wire.setWireTimeout(WIRE_TIMEOUT_US, true);
+#elif defined(ESP32)
+  Wire.setTimeOut(_coreTimeoutMs);
+#endif
+  _busTimeoutArmed = false;
+}
+
+// Error for a read that came back short: 5 when the Wire hardware timeout cut it off, 4 otherwise
+uint8_t Simple_Wire::ShortReadError() {
+#if defined(WIRE_HAS_TIMEOUT)
+  if (Wire.getWireTimeoutFlag()) {
+    Wire.clearWireTimeoutFlag();
+    return 5; // Timeout
+  }
+#endif
+  return 4; // Incomplete read
+}
+
+Simple_Wire &Simple_Wire::SetBudget(uint32_t us) {
+  _budgetUs = us;
+  if (!us && !_batchDeadline)
+    RestoreBusTimeout();
+  return *this;
+}
+
+Simple_Wire &Simple_Wire::ClearDeadline() {
+  _batchDeadline = false;
+  if (!_budgetUs)
+    RestoreBusTimeout();
+  return *this;
+}
+
+// General call (address 0x00) command, every device that listens to general calls acts on it at the same time
+Simple_Wire &Simple_Wire::GeneralCall(uint8_t command) {
+  if (!_Begin) {
+    ErrorMessage = 4; // Not initialized
+    return *this;
+  }
+  ErrorMessage = 0;
+  StartBudget();
+  if (!HaveTime(BusTimeUs(2))) {
+    ErrorMessage = 5; // Timeout
+    return *this;
+  }
+  Wire.beginTransmission(0x00);
+  Wire.write(command);
+  ErrorMessage = Wire.endTransmission();
+  _syncMicros = micros(); // the trigger lands on the STOP
+  return *this;
+}
+
+// Broadcast register write to the general call address for devices that start a conversion this way
+Simple_Wire &Simple_Wire::SyncTrigger(uint8_t regAddr, uint8_t Val) {
+  if (!_Begin) {
+    ErrorMessage = 4; // Not initialized
+    return *this;
+  }
+  ErrorMessage = 0;
+  StartBudget();
+  if (!HaveTime(BusTimeUs(3))) {
+    ErrorMessage = 5; // Timeout
+    return *this;
+  }
+  Wire.beginTransmission(0x00);
+  Wire.write(regAddr);
+  Wire.write(Val);
+  ErrorMessage = Wire.endTransmission();
+  _syncMicros = micros();
+  return *this;
+}
+
+// Wait for the conversion time measured from the trigger, not from now, so bus time already spent is not paid twice
+Simple_Wire &Simple_Wire::SyncWait(uint32_t us) {
+  while ((uint32_t)(micros() - _syncMicros) < us) {
+    yield();
+  }
+  return *this;
+}
+
+// Poll a status register on each device until it reports ready, giving up us microseconds after the trigger.
+// Ready when the masked bits are all set (readyHigh) or all clear (!readyHigh). Devices are waited on in order,
+// they were all triggered together so by the time one is ready the rest usually are too.
+Simple_Wire &Simple_Wire::SyncWaitReady(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, uint8_t mask, bool readyHigh, uint32_t us) {
+  uint8_t d = 0;
+  while (d < count) {
+    uint8_t Status = 0;
+    ReadByte(Addresses[d], regAddr, &Status);
+    if (Success() && ((Status & mask) == (readyHigh ? mask : 0))) {
+      d++;
+      continue;
+    }
+    if ((uint32_t)(micros() - _syncMicros) >= us) {
+      ErrorMessage = 5; // Timeout, device never reported ready
+      return *this;
+    }
+    yield();
+  }
+  ErrorMessage = 0;
+  return *this;
+}
+
+// SMBus transfer engine used by the block, block process call and PEC functions.
+// Write part: command, [count], wLength bytes. Read part (rLength or rBlock): repeated start, [count], data.
+// The PEC is folded in byte by byte as the bytes are written or pulled out of the Wire buffer, so checking it costs one table lookup per byte.
+Simple_Wire &Simple_Wire::SMBusTransfer(uint8_t AltAddress, uint8_t command, uint8_t wLength, const uint8_t *wData, bool wBlock, uint8_t rLength, uint8_t *rData, bool rBlock) {
+  if (!_Begin) {
+    ErrorMessage = 4; // Not initialized
+    return *this;
+  }
+  I2CReadCount = 0;
+  I2CWriteCount = 0;
+  ErrorMessage = 0;
+  yield();
+
+  bool Reading = rBlock || rLength;
+  uint8_t Overhead = (wBlock ? 2 : 1) + (_pec && !Reading ? 1 : 0); // command, count and PEC bytes
+  if ((uint16_t)wLength + Overhead > WIRE_BUFFER_LENGTH || (uint16_t)rLength + (rBlock ? 1 : 0) + (_pec ? 1 : 0) > WIRE_BUFFER_LENGTH) {
+    ErrorMessage = 1; // Data too long to fit into the Wire buffer
+    return *this;
+  }
+
+  // The whole transfer is checked up front, a process call must not be abandoned between its write and read halves
+  StartBudget();
+  if (!HaveTime(BusTimeUs(wLength + rLength + 6))) {
+    ErrorMessage = 5; // Timeout
+    return *this;
+  }
+
+  uint8_t crc = Crc8(0, AltAddress << 1);
+  Wire.beginTransmission(AltAddress);
+  Wire.write(command);
+  crc = Crc8(crc, command);
+  if (wBlock) {
+    Wire.write(wLength);
+    crc = Crc8(crc, wLength);
+  }
+  for (uint8_t i = 0; i < wLength; i++) {
+    Wire.write(wData[i]);
+    crc = Crc8(crc, wData[i]);
+  }
+  I2CWriteCount = wLength;
+
+  if (!Reading) {
+    if (_pec)
+      Wire.write(crc);
+    ErrorMessage = Wire.endTransmission();
+    return *this;
+  }
+
+  ErrorMessage = Wire.endTransmission(false); // false = repeated start, no STOP
+  if (!Success())
+    return *this;
+  crc = Crc8(crc, (AltAddress << 1) | 1);
+
+  // A block device tells us its length in the first byte, so request the most we will accept and stop at its count.
+  uint8_t Request = rLength + (rBlock ? 1 : 0) + (_pec ? 1 : 0);
+  Wire.requestFrom(static_cast<uint8_t>(AltAddress), static_cast<size_t>(Request), static_cast<bool>(true)); // send STOP after read
+
+  uint8_t Count = rLength;
+  if (rBlock) {
+    if (!Wire.available()) {
+      ErrorMessage = ShortReadError();
+      return *this;
+    }
+    Count = Wire.read();
+    crc = Crc8(crc, Count);
+    Val = Count;
+    if (Count > rLength) {
+      ErrorMessage = 4; // Incomplete read, the device's block is larger than the caller's buffer
+      while (Wire.available())
+        Wire.read();
+      return *this;
+    }
+  }
+
+  for (uint8_t i = 0; i < Count; i++) {
+    if (!Wire.available()) {
+      ErrorMessage = ShortReadError();
+      return *this;
+    }
+    rData[i] = Wire.read();
+    crc = Crc8(crc, rData[i]);
+    I2CReadCount++;
+  }
+
+  if (_pec) {
+    if (!Wire.available()) {
+      ErrorMessage = ShortReadError(); // PEC byte missing
+    } else if ((uint8_t)Wire.read() != crc) {
+      ErrorMessage = 6; // PEC mismatch
+    }
+  }
+  while (Wire.available()) // discard anything past the device's count
+    Wire.read();
+  return *this;
+}
+
+// SMBus Process Call, words go out and come back LSB first
+Simple_Wire &Simple_Wire::ProcessCall(uint8_t AltAddress, uint8_t command, uint16_t Val, uint16_t *Data) {
+  uint8_t wBuf[2] = {(uint8_t)Val, (uint8_t)(Val >> 8)};
+  uint8_t rBuf[2] = {0, 0};
+  SMBusTransfer(AltAddress, command, 2, wBuf, false, 2, rBuf, false);
+  if (I2CReadCount == 2) {
+    Data[0] = (uint16_t)rBuf[0] | ((uint16_t)rBuf[1] << 8);
+    this->Val = Data[0];
+  }
+  I2CReadCount /= 2; // count words, not bytes
+  I2CWriteCount /= 2;
+  return *this;
+}
+
 // Scan for i2c Devices
 Simple_Wire &Simple_Wire::I2C_Scanner() {
   if (!_Begin)
@@ -139,7 +609,7 @@ Simple_Wire &Simple_Wire::I2C_Scanner() {
     yield();
 
     // Check overall scan timeout
-    if (millis() - scanStartTime > _timeoutMs * 2) { // Allow 2x timeout for full scan
+    if (_timeoutMs && millis() - scanStartTime > _timeoutMs * 2) { // Allow 2x timeout for full scan, 0 = no limit
       Serial.println("Scan timeout - stopping early");
       break;
     }
@@ -181,14 +651,13 @@ uint8_t Simple_Wire::Check_Address(uint8_t Address, bool verbose) {
     Serial.println(Address, HEX);
   }
 
-  uint32_t startTime = millis();
-  Wire.beginTransmission(Address);
-
   // Check timeout before endTransmission
-  if (millis() - startTime > _timeoutMs) {
+  StartBudget();
+  if (!HaveTime(BusTimeUs(1))) {
     ErrorMessage = 5; // Timeout
     return false;
   }
+  Wire.beginTransmission(Address);
 
   ErrorMessage = Wire.endTransmission();
   return (ErrorMessage == 0);
@@ -266,14 +735,17 @@ Simple_Wire &Simple_Wire::TRead(uint8_t AltAddress, uint8_t regAddr, uint8_t len
   yield();
   byteCount = constrain(byteCount, 1, 8);
 
-  uint32_t startTime = millis();
+  StartBudget();
 
   // for (uint8_t k = 0; k < length * byteCount; k += min(length * byteCount, WIRE_BUFFER_LENGTH / byteCount)) // Process data in chunks based on the Wire buffer length.
 
   uint16_t totalBytes = (uint16_t)length * byteCount;
   for (uint16_t k = 0; k < totalBytes; k += min<uint16_t>(totalBytes - k, WIRE_BUFFER_LENGTH)) {
-    // Check timeout before each chunk
-    if (millis() - startTime > _timeoutMs) {
+    // uint8_t readSize = min(length * byteCount - k, WIRE_BUFFER_LENGTH / byteCount);
+    uint8_t readSize = min<uint16_t>(totalBytes - k, WIRE_BUFFER_LENGTH);
+
+    // Check what is left of the budget before each chunk, don't start one that can't finish in time
+    if (!HaveTime(BusTimeUs(readSize + 3))) {
       ErrorMessage = 5; // Timeout
       break;
     }
@@ -282,18 +754,11 @@ Simple_Wire &Simple_Wire::TRead(uint8_t AltAddress, uint8_t regAddr, uint8_t len
     Wire.write(regAddr);
     ErrorMessage = Wire.endTransmission();
     if (Success()) {
-      // uint8_t readSize = min(length * byteCount - k, WIRE_BUFFER_LENGTH / byteCount);
-      uint8_t readSize = min<uint16_t>(totalBytes - k, WIRE_BUFFER_LENGTH);
-      Wire.requestFrom(static_cast<uint8_t>(AltAddress), static_cast<size_t>(readSize)); //
+      // A short read means the device stopped answering or the Wire timeout (armed with our budget) cut it off
+      if (Wire.requestFrom(static_cast<uint8_t>(AltAddress), static_cast<size_t>(readSize)) != readSize)
+        ErrorMessage = ShortReadError();
 
-      uint32_t readStartTime = millis();
       while (Wire.available() && I2CReadCount < length) {
-        // Check timeout during read
-        if (millis() - readStartTime > _timeoutMs) {
-          ErrorMessage = 5; // Timeout
-          break;
-        }
-
         Data[I2CReadCount] = 0; // Clear the destination value for this word
         uint8_t ByteVal = 0;
         for (int8_t b = byteCount - 1; b >= 0; b--) {
@@ -306,7 +771,11 @@ Simple_Wire &Simple_Wire::TRead(uint8_t AltAddress, uint8_t regAddr, uint8_t len
         I2CReadCount++;
       }
     }
+    if (!Success())
+      break;
   }
+  if (I2CReadCount < length && Success())
+    ErrorMessage = ShortReadError();
 
   Val = (uint64_t)Data[0]; // assign the first value to Val. use .Value() to retrieve the value and dont forget to cast it back to the type you are getting.
                            // Example int16_t Data;  Serial.print((int16_t) INA.ReadInt(0x07U,&Data).value());
@@ -322,19 +791,18 @@ Simple_Wire &Simple_Wire::TWrite(uint8_t AltAddress, uint8_t regAddr, uint8_t le
   ErrorMessage = 0;
   yield();
 
-  uint32_t startTime = millis();
+  // Check the budget before beginTransmission(), on ESP32 that takes the Wire lock and only endTransmission() releases it
+  StartBudget();
+  if (!HaveTime(BusTimeUs((uint16_t)length * ByteC + 2))) {
+    ErrorMessage = 5; // Timeout
+    return *this;
+  }
 
   Wire.beginTransmission(AltAddress);
   Wire.write(regAddr); // send register address
 
   // Write each value, sending ByteC bytes per element.
   for (uint8_t i = 0; i < length; i++) {
-    // Check timeout before each element
-    if (millis() - startTime > _timeoutMs) {
-      ErrorMessage = 5; // Timeout
-      break;
-    }
-
     // Send MSB and LSB according to your defined shift values
     for (int8_t b = ByteC - 1; b >= 0; b--) {
       uint8_t Shift = ReverseByteShift ? (ByteC - 1 - b) * 8 : b * 8;
@@ -343,13 +811,67 @@ Simple_Wire &Simple_Wire::TWrite(uint8_t AltAddress, uint8_t regAddr, uint8_t le
     I2CWriteCount++;
   }
 
-  // Check timeout before final transmission
-  if (millis() - startTime > _timeoutMs) {
-    ErrorMessage = 5; // Timeout
-  } else {
-    ErrorMessage = Wire.endTransmission();
+  ErrorMessage = Wire.endTransmission();
+
+  return *this;
+}
+
+// Synchronized readout of one value from each device in Addresses.
+// Every device is addressed with a repeated start so the bus is never released between the register write and the read
+// (regAddr < 0 skips the write for parts without a register pointer),
+// and nothing else (yield) runs between devices except the per device timestamp and budget check.
+// A device that fails is skipped, ErrorMessage holds the last failure and I2CReadCount the number of devices read.
+template <typename T>
+Simple_Wire &Simple_Wire::TSyncRead(const uint8_t *Addresses, uint8_t count, int16_t regAddr, uint8_t byteCount, T *Data, uint32_t *Stamps) {
+  if (!_Begin) {
+    ErrorMessage = 4; // Not initialized
+    return *this;
   }
+  I2CReadCount = 0;
+  ErrorMessage = 0;
+  yield();
+  byteCount = constrain(byteCount, 1, 8);
+
+  StartBudget();
+
+  for (uint8_t d = 0; d < count; d++) {
+    uint8_t Address = Addresses[d];
+    Data[d] = 0;
+    if (Stamps)
+      Stamps[d] = 0;
 
+    // Fail fast on timeout, a device that can't be read in what is left of the budget is not started
+    if (!HaveTime(BusTimeUs(byteCount + 3))) {
+      ErrorMessage = 5; // Timeout
+      for (; d < count; d++) { // skipped devices follow the same rule as failed ones
+        Data[d] = 0;
+        if (Stamps)
+          Stamps[d] = 0;
+      }
+      break;
+    }
+
+    uint8_t Error = 0;
+    if (regAddr >= 0) {
+      Wire.beginTransmission(Address);
+      Wire.write((uint8_t)regAddr);
+      Error = Wire.endTransmission(false); // false = repeated start, no STOP
+    }
+    if (Error == 0 && Wire.requestFrom(static_cast<uint8_t>(Address), static_cast<size_t>(byteCount), static_cast<bool>(true)) == byteCount) {
+      if (Stamps)
+        Stamps[d] = micros();
+      for (int8_t b = byteCount - 1; b >= 0; b--) {
+        uint8_t Shift = ReverseByteShift ? (byteCount - 1 - b) * 8 : b * 8;
+        Data[d] |= ((uint64_t)(uint8_t)Wire.read() << Shift);
+      }
+      I2CReadCount++;
+    } else {
+      ErrorMessage = (Error != 0) ? Error : ShortReadError(); // NACK from endTransmission or incomplete read
+    }
+  }
+
+  if (count)
+    Val = (uint64_t)Data[0];
   return *this;
 }
 
@@ -396,3 +918,17 @@ template Simple_Wire &Simple_Wire::TWriteThenRead<uint64_t>(uint8_t, uint64_t *,
 template Simple_Wire &Simple_Wire::TWriteThenRead<uint64_t>(uint8_t, uint8_t, uint64_t *, uint8_t);
 template Simple_Wire &Simple_Wire::TWriteThenRead<int64_t>(uint8_t, int64_t *, uint8_t);
 template Simple_Wire &Simple_Wire::TWriteThenRead<int64_t>(uint8_t, uint8_t, int64_t *, uint8_t);
+
+// Target mode template instantiations
+template Simple_Wire &Simple_Wire::TTargetWrite<uint8_t>(uint8_t, uint8_t, uint8_t);
+template Simple_Wire &Simple_Wire::TTargetWrite<int16_t>(uint8_t, uint8_t, int16_t);
+template Simple_Wire &Simple_Wire::TTargetWrite<uint16_t>(uint8_t, uint8_t, uint16_t);
+template Simple_Wire &Simple_Wire::TTargetWrite<int32_t>(uint8_t, uint8_t, int32_t);
+template Simple_Wire &Simple_Wire::TTargetWrite<uint32_t>(uint8_t, uint8_t, uint32_t);
+
+// Synchronized sampling template instantiations
+template Simple_Wire &Simple_Wire::TSyncRead<uint8_t>(const uint8_t *, uint8_t, int16_t, uint8_t, uint8_t *, uint32_t *);
+template Simple_Wire &Simple_Wire::TSyncRead<int16_t>(const uint8_t *, uint8_t, int16_t, uint8_t, int16_t *, uint32_t *);
+template Simple_Wire &Simple_Wire::TSyncRead<uint16_t>(const uint8_t *, uint8_t, int16_t, uint8_t, uint16_t *, uint32_t *);
+template Simple_Wire &Simple_Wire::TSyncRead<int32_t>(const uint8_t *, uint8_t, int16_t, uint8_t, int32_t *, uint32_t *);
+template Simple_Wire &Simple_Wire::TSyncRead<uint32_t>(const uint8_t *, uint8_t, int16_t, uint8_t, uint32_t *, uint32_t *);
@@ -45,6 +45,17 @@ THE SOFTWARE.
 #endif
 #endif
 
+#ifndef WIRE_TIMEOUT_US
+// AVR Wire hardware timeout set by begin() and put back when a microsecond budget ends
+#define WIRE_TIMEOUT_US 3000
+#endif
+
+// Target mode register flags, one byte per register in the Flags array passed to beginTarget()
+#define SW_REG_RW 0x00       // host may read and write
+#define SW_REG_RO 0x01       // host writes are ignored
+#define SW_REG_WO 0x02       // host reads return 0x00
+#define SW_REG_VOLATILE 0x04 // write callback fires on every host write, not only when the value changes
+
 class Simple_Wire {
 private:
   bool _Begin = false;
@@ -65,11 +76,45 @@ private:
   Simple_Wire &TRead(uint8_t AltAddress, uint8_t regAddr, uint8_t length, uint8_t ByteC, T *Data);
   template <typename T>
   Simple_Wire &TWrite(uint8_t AltAddress, uint8_t regAddr, uint8_t length, uint8_t ByteC, T *Data);
+  template <typename T>
+  Simple_Wire &TSyncRead(const uint8_t *Addresses, uint8_t count, int16_t regAddr, uint8_t byteCount, T *Data, uint32_t *Stamps);
+  Simple_Wire &SMBusTransfer(uint8_t AltAddress, uint8_t command, uint8_t wLength, const uint8_t *wData, bool wBlock, uint8_t rLength, uint8_t *rData, bool rBlock);
+  static const uint8_t SMBusCrcTable[256];
+  static uint8_t Crc8(uint8_t crc, uint8_t data) { return pgm_read_byte(&SMBusCrcTable[crc ^ data]); } // CRC-8 (x^8 + x^2 + x + 1) one byte at a time
+  void StartBudget();
+  bool HaveTime(uint32_t needUs = 0);
+  void RestoreBusTimeout();
+  uint8_t ShortReadError();
+  uint32_t BusTimeUs(uint16_t bytes) { return ((uint32_t)bytes * 9UL * 1000UL) / (_clockHz / 1000UL); } // 8 data bits + ACK per byte
+  template <typename T>
+  Simple_Wire &TTargetWrite(uint8_t regAddr, uint8_t ByteC, T Val);
+  static void TargetReceive(int count);
+  static void TargetRequest();
+  static Simple_Wire *_target; // Wire target callbacks carry no context, only one target instance is served
   static const __FlashStringHelper *const i2cErrorMessages[5];
   bool Verbose = false;
   uint64_t Val = 0;
   uint8_t ErrorMessage = 0;
   uint32_t _timeoutMs = 100; // Default 100ms timeout
+  uint32_t _budgetUs = 0;    // per transaction budget in microseconds, 0 = use _timeoutMs
+  uint32_t _deadlineStart = 0;
+  uint32_t _deadlineUs = 0;
+  bool _batchDeadline = false; // StartDeadline() budget shared by every call until ClearDeadline()
+  bool _busTimeoutArmed = false;
+  uint16_t _coreTimeoutMs = 50; // ESP32 Wire timeout to put back when a budget ends
+  uint32_t _clockHz = 400000;
+  uint32_t _syncMicros = 0;  // micros() at the last general call / broadcast trigger
+  bool _pec = false;         // SMBus Packet Error Code on block and process call transfers
+  // Target mode register bank
+  uint8_t *volatile _bankFront = nullptr; // served to the host
+  uint8_t *volatile _bankBack = nullptr;  // staging copy for TargetSwap(), nullptr when not double buffered
+  const uint8_t *_bankFlags = nullptr;
+  uint8_t _bankSize = 0;
+  bool _bankHasWO = false;
+  volatile uint8_t _regPtr = 0;
+  uint8_t _dirtyLo = 0xFF; // staged range waiting for TargetSwap()
+  uint8_t _dirtyHi = 0;
+  void (*_onTargetWrite)(uint8_t regAddr, uint8_t length) = nullptr;
 
 public:
   /*
@@ -79,7 +124,8 @@ public:
   2 Received NACK on transmission of address
   3 Received NACK on transmission of data
   4 Other Error (including incomplete read/write)
-  5 Timeout (operation exceeded _timeoutMs)
+  5 Timeout (operation exceeded its microsecond budget or _timeoutMs)
+  6 SMBus PEC mismatch (data received but the Packet Error Code did not match)
   */
 
   uint8_t devAddr = 0;
@@ -299,8 +345,27 @@ public:
   Simple_Wire &TWriteThenRead(uint8_t regAddr, T *readBuffer, uint8_t readLength);
   template <typename T>
   Simple_Wire &TWriteThenRead(uint8_t altAddress, uint8_t regAddr, T *readBuffer, uint8_t readLength);
-  Simple_Wire &SetTimeout(uint32_t timeoutMs = 100);
+  Simple_Wire &SetTimeout(uint32_t timeoutMs = 100); // 0 = no limit
   uint32_t GetTimeout() { return _timeoutMs; };
+  Simple_Wire &SetClock(uint32_t hz = 400000);
+
+  // Deadline budgets
+  // SetBudget(us) gives every following transaction its own microsecond budget (0 returns to SetTimeout()).
+  // StartDeadline(us) starts one budget shared by all calls until ClearDeadline(), once it runs out the remaining calls
+  // return error 5 without touching the bus. Multi-chunk reads carry the remaining budget from chunk to chunk and a
+  // transfer whose estimated bus time (9 bit times per byte at SetClock()) does not fit what is left is not started.
+  // A transfer that has started is cut off by the core's Wire timeout, set to the remaining budget on AVR (microseconds)
+  // and ESP32 (rounded up to milliseconds). ESP8266, RP2040 and other cores keep their own Wire timeout, so a clock
+  // stretching device can still hold a started transfer past the budget there.
+  // While a budget is active the Wire timeout keeps the last value we set, SetBudget(0) or ClearDeadline() puts the
+  // core default back before handing Wire to other code.
+  // Example: at 400 kHz each ReadInts(reg, 3, ..) is 9 bytes, about 203 us on the bus, so two need a bit over 400 us:
+  // I2C.StartDeadline(500).ReadInts(0x3B, 3, Accel).ReadInts(0x43, 3, Gyro).ClearDeadline();
+  Simple_Wire &SetBudget(uint32_t us = 0);
+  uint32_t GetBudget() { return _budgetUs; };
+  Simple_Wire &StartDeadline(uint32_t us);
+  Simple_Wire &ClearDeadline();
+  uint32_t RemainingUs();
 
   // WriteThenRead for specific data types
   // 8-bit types
@@ -326,6 +391,81 @@ public:
   Simple_Wire &WriteThenRead(uint8_t altAddress, uint8_t regAddr, uint64_t *readBuffer, uint8_t readLength) { return TWriteThenRead<uint64_t>(altAddress, regAddr, readBuffer, readLength); };
   Simple_Wire &WriteThenRead(uint8_t regAddr, int64_t *readBuffer, uint8_t readLength) { return TWriteThenRead<int64_t>(regAddr, readBuffer, readLength); };
   Simple_Wire &WriteThenRead(uint8_t altAddress, uint8_t regAddr, int64_t *readBuffer, uint8_t readLength) { return TWriteThenRead<int64_t>(altAddress, regAddr, readBuffer, readLength); };
+
+  // SMBus functions
+  // Block transfers send or receive a length byte ahead of the data, words are sent LSB first as SMBus requires.
+  // With SetPEC(true) a CRC-8 Packet Error Code is appended to writes and checked on reads (ErrorMessage 6 on mismatch).
+  // A block read stores up to length bytes in Data, ReadCount() is the bytes stored and Value() the device's byte count.
+  // A block longer than length is an incomplete read (error 4), Value() still tells you how big a buffer it needs.
+  // The whole block plus length and PEC bytes must fit in WIRE_BUFFER_LENGTH.
+  Simple_Wire &SetPEC(bool PEC = true) {
+    _pec = PEC;
+    return *this;
+  };
+  bool GetPEC() { return _pec; };
+  Simple_Wire &BlockRead(uint8_t command, uint8_t length, uint8_t *Data) { return SMBusTransfer(devAddr, command, 0, nullptr, false, length, Data, true); };
+  Simple_Wire &BlockRead(uint8_t AltAddress, uint8_t command, uint8_t length, uint8_t *Data) { return SMBusTransfer(AltAddress, command, 0, nullptr, false, length, Data, true); };
+  Simple_Wire &BlockWrite(uint8_t command, uint8_t length, const uint8_t *Data) { return SMBusTransfer(devAddr, command, length, Data, true, 0, nullptr, false); };
+  Simple_Wire &BlockWrite(uint8_t AltAddress, uint8_t command, uint8_t length, const uint8_t *Data) { return SMBusTransfer(AltAddress, command, length, Data, true, 0, nullptr, false); };
+  // Process Call: write a word and read a word back in one transaction
+  Simple_Wire &ProcessCall(uint8_t command, uint16_t Val, uint16_t *Data) { return ProcessCall(devAddr, command, Val, Data); };
+  Simple_Wire &ProcessCall(uint8_t AltAddress, uint8_t command, uint16_t Val, uint16_t *Data);
+  // Block Process Call: write a block and read a block back in one transaction
+  Simple_Wire &BlockProcessCall(uint8_t command, uint8_t wLength, const uint8_t *wData, uint8_t rLength, uint8_t *rData) { return SMBusTransfer(devAddr, command, wLength, wData, true, rLength, rData, true); };
+  Simple_Wire &BlockProcessCall(uint8_t AltAddress, uint8_t command, uint8_t wLength, const uint8_t *wData, uint8_t rLength, uint8_t *rData) { return SMBusTransfer(AltAddress, command, wLength, wData, true, rLength, rData, true); };
+
+  // Target (slave) mode
+  // The board answers at address with a register bank the sketch declares (uint8_t Bank[N]). The host writes a register
+  // pointer followed by data (the pointer auto-increments across written bytes) and reads hand the bank to Wire from the
+  // pointer on. Reads do not move the pointer, Wire can't tell us how many bytes the host clocked out, so every read
+  // restarts at the last written pointer.
+  // Flags (optional, N bytes of SW_REG_...) protect registers. With a Shadow bank (N bytes) TargetWrite...() stages values
+  // and TargetSwap() publishes them all at once, so the host never reads half of a multi-byte value.
+  // Without a Shadow each TargetWrite...() call is applied with interrupts off (a spinlock on ESP32). On other multi-core
+  // boards updates are only atomic while Wire and the sketch run on the same core.
+  Simple_Wire &beginTarget(uint8_t address, uint8_t *Bank, uint8_t size, const uint8_t *Flags = nullptr, uint8_t *Shadow = nullptr, int sdaPin = 0, int sclPin = 1);
+  Simple_Wire &OnTargetWrite(void (*callback)(uint8_t regAddr, uint8_t length)) { // called from the receive interrupt after a host write changed the bank
+    _onTargetWrite = callback;
+    return *this;
+  };
+  Simple_Wire &TargetWriteByte(uint8_t regAddr, uint8_t Val) { return TTargetWrite<uint8_t>(regAddr, 1, Val); };
+  Simple_Wire &TargetWriteBytes(uint8_t regAddr, uint8_t length, const uint8_t *Data);
+  Simple_Wire &TargetWriteInt(uint8_t regAddr, int16_t Val) { return TTargetWrite<int16_t>(regAddr, 2, Val); };
+  Simple_Wire &TargetWriteUInt(uint8_t regAddr, uint16_t Val) { return TTargetWrite<uint16_t>(regAddr, 2, Val); };
+  Simple_Wire &TargetWrite32(uint8_t regAddr, int32_t Val) { return TTargetWrite<int32_t>(regAddr, 4, Val); };
+  Simple_Wire &TargetWriteU32(uint8_t regAddr, uint32_t Val) { return TTargetWrite<uint32_t>(regAddr, 4, Val); };
+  Simple_Wire &TargetSwap(); // publish everything staged since the last swap
+  uint8_t TargetRead(uint8_t regAddr) { return (regAddr < _bankSize) ? _bankFront[regAddr] : 0; };
+  uint8_t TargetPointer() { return _regPtr; };
+
+  // Synchronized sampling
+  // Trigger every device at once with a general call (address 0x00), wait for the conversion, then read
+  // all devices back in one pass. Addresses is an array of count device addresses, Data receives one value
+  // per device and Stamps (optional) receives the micros() time each device's result arrived (0 on failure).
+  // Leave out regAddr for parts without a register pointer (MCP342x and similar), they are read with no write phase.
+  // Example (MCP3421 x4, 16 bit): I2C.GeneralCall(0x08).SyncWait(70000).SyncReadInts(Adc, 4, Samples, Stamps);
+  Simple_Wire &GeneralCall(uint8_t command);                // General call command byte (e.g. 0x04 latch, 0x06 reset, 0x08 convert)
+  Simple_Wire &SyncTrigger(uint8_t regAddr, uint8_t Val);   // Broadcast a register write to every device that accepts general calls
+  Simple_Wire &SyncWait(uint32_t us);                       // Wait until us microseconds have passed since the trigger
+  // Or poll each device's status register until (status & mask) shows ready, error 5 if not ready us after the trigger
+  // (parts with a register pointer only, regAddr is written before each poll)
+  Simple_Wire &SyncWaitReady(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, uint8_t mask, bool readyHigh, uint32_t us);
+  uint32_t SyncTime() { return _syncMicros; };              // micros() when the last trigger completed
+
+  Simple_Wire &SyncReadBytes(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, uint8_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<uint8_t>(Addresses, count, regAddr, 1, Data, Stamps); };
+  Simple_Wire &SyncReadBytes(const uint8_t *Addresses, uint8_t count, uint8_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<uint8_t>(Addresses, count, -1, 1, Data, Stamps); };
+  Simple_Wire &SyncReadInts(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, int16_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<int16_t>(Addresses, count, regAddr, 2, Data, Stamps); };
+  Simple_Wire &SyncReadInts(const uint8_t *Addresses, uint8_t count, int16_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<int16_t>(Addresses, count, -1, 2, Data, Stamps); };
+  Simple_Wire &SyncReadUInts(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, uint16_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<uint16_t>(Addresses, count, regAddr, 2, Data, Stamps); };
+  Simple_Wire &SyncReadUInts(const uint8_t *Addresses, uint8_t count, uint16_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<uint16_t>(Addresses, count, -1, 2, Data, Stamps); };
+  Simple_Wire &SyncRead24s(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, int32_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<int32_t>(Addresses, count, regAddr, 3, Data, Stamps); };
+  Simple_Wire &SyncRead24s(const uint8_t *Addresses, uint8_t count, int32_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<int32_t>(Addresses, count, -1, 3, Data, Stamps); };
+  Simple_Wire &SyncReadU24s(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, uint32_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<uint32_t>(Addresses, count, regAddr, 3, Data, Stamps); };
+  Simple_Wire &SyncReadU24s(const uint8_t *Addresses, uint8_t count, uint32_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<uint32_t>(Addresses, count, -1, 3, Data, Stamps); };
+  Simple_Wire &SyncRead32s(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, int32_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<int32_t>(Addresses, count, regAddr, 4, Data, Stamps); };
+  Simple_Wire &SyncRead32s(const uint8_t *Addresses, uint8_t count, int32_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<int32_t>(Addresses, count, -1, 4, Data, Stamps); };
+  Simple_Wire &SyncReadU32s(const uint8_t *Addresses, uint8_t count, uint8_t regAddr, uint32_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<uint32_t>(Addresses, count, regAddr, 4, Data, Stamps); };
+  Simple_Wire &SyncReadU32s(const uint8_t *Addresses, uint8_t count, uint32_t *Data, uint32_t *Stamps = nullptr) { return TSyncRead<uint32_t>(Addresses, count, -1, 4, Data, Stamps); };
 };
 
 extern TwoWire Wire;